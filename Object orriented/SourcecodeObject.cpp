@@ -13,6 +13,18 @@
 // to disk or loaded from disk. The database elements can be sorted either by name or
 // by slew rate. There is also the facility to display the elements.
 //
+// The database can be queried for the elements with a given number of pins and at
+// least a given slew rate. The results of recent queries are kept in a small cache
+// until an element they depend on is entered or the database is loaded.
+//
+// Elements can be searched for by part of their name or by a name with a few
+// characters wrong, using an index of the three character sequences in the names.
+//
+// Elements can also be imported from CSV and JSON files, and the results of a
+// query exported to a CSV or JSON file or to the screen. Files are read through a
+// fixed size buffer and processed in small batches so that any size of file can be
+// handled.
+//
 // Only a single database is required and the file name is fixed in the code (as 
 // DATABASE_FILENAME). This means that each time the database is saved to disk,
 // any previous data in the file is overwritten. Also, when a database is loaded
@@ -21,26 +33,40 @@
 #include <iostream>
 #include <fstream>
 #include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <math.h>
+#include <chrono> //std:: steady_clock
 #include <algorithm> //std:: sort
+#include <type_traits> //std:: is_trivially_destructible
 using namespace std;
 
+// the size of the name of an op-amp, including the terminating character
+#define OPAMP_NAME_MAX 20
+
+// the length of the fixed array to be used for database - must be at least one
+// and no greater the maximum value allowed in an unsigned long (see the file 
+// limits.h)
+#define DATABASE_MAX 10
+
 // Class containing OpAmp parameters
 // Provides functions that access the private members and overloaded the stream operators
 class OpAmps
 {
 private:
-	char Name[20];				// the name of the op - amp (e.g. "741")
+	char Name[OPAMP_NAME_MAX];	// the name of the op - amp (e.g. "741")
 	unsigned int PinCount;		// the number of pins in the package
 	double SlewRate;			// the slew rate in volts per microsecond
 
 public:
 	OpAmps();					// constructor 
-	~OpAmps(); 					// destructor
 
 	void SetOpAmpValues();		// setting OpAmp parameters function
+	void SetOpAmpValues(const char *NewName, unsigned int NewPinCount, double NewSlewRate);
 	void DisplayOpAmpValues();  // displaying op-amps
 
-	string GetNameOpAmp();		// provides access to private Name
+	const char *GetNameOpAmp();	// provides access to private Name
 	int GetPinCountOpAmp();		// provides access to private PinCount
 	double GetSlewRateOpAmp();	// provides access to private SlewRate
 
@@ -48,6 +74,22 @@ public:
 	friend ifstream &operator >> (ifstream &, OpAmps &); // overloaded input operator function
 };
 
+// OpAmps has no destructor, so releasing the database does no work for each element
+static_assert(is_trivially_destructible<OpAmps>::value, "OpAmps must be trivially destructible");
+
+// Skip the rest of a name too long to be held, so that it is not read as the
+// next value
+// Arguments:
+//   (1) the stream the name is read from
+// Returns: void
+static void SkipRestOfName(istream &instream)
+{
+	while (instream.good() && !isspace(instream.peek()) && instream.peek() != EOF)
+	{
+		instream.get();
+	}
+}
+
 //Constructor and destructor functions
 OpAmps::OpAmps() // constructor definition of class-OpAmps with initialised values
 {
@@ -56,18 +98,15 @@ OpAmps::OpAmps() // constructor definition of class-OpAmps with initialised valu
 	SlewRate = 0;	// the slew rate in volts per microsecond
 }
 
-OpAmps::~OpAmps() // destructor function definition
-{
-	cout << ".Goodbye." << endl;
-}
-
 // Structure for ArrayOfOpAmps-objects 
 void OpAmps::SetOpAmpValues() //Input user data to alter database length by adding an ArrayOfOpAmps-object
 {
 	cout << "Add new data" << endl;
 	cout << "------------" << endl;
 	cout << "Enter op-amp name: ";
+	cin.width(OPAMP_NAME_MAX);
 	cin >> Name;
+	SkipRestOfName(cin);
 	cout << "Enter number of pins: ";
 	cin >> PinCount;
 	cout << "Enter slew rate: ";
@@ -75,6 +114,14 @@ void OpAmps::SetOpAmpValues() //Input user data to alter database length by addi
 	cout << endl;
 }
 
+void OpAmps::SetOpAmpValues(const char *NewName, unsigned int NewPinCount, double NewSlewRate) // set OpAmp parameters from imported data
+{
+	strncpy(Name, NewName, OPAMP_NAME_MAX - 1);
+	Name[OPAMP_NAME_MAX - 1] = '\0';
+	PinCount = NewPinCount;
+	SlewRate = NewSlewRate;
+}
+
 void OpAmps::DisplayOpAmpValues() // Display current ArrayOfOpAmps-objects in the database and their parameters
 {
 	// display a title
@@ -89,7 +136,7 @@ void OpAmps::DisplayOpAmpValues() // Display current ArrayOfOpAmps-objects in th
 }
 
 // Fucntions for private member access
-string OpAmps::GetNameOpAmp() // function to access private members of class-OpAmps
+const char *OpAmps::GetNameOpAmp() // function to access private members of class-OpAmps
 {
 	return Name;
 }
@@ -118,183 +165,1230 @@ ostream &operator<<(ostream& outstream, OpAmps& ArrayOfOpAmps) // output overloa
 
 ifstream &operator >>(ifstream& instream, OpAmps& ArrayOfOpAmps) // input overloaded function definition
 {
+	instream.width(OPAMP_NAME_MAX);
 	instream >> ArrayOfOpAmps.Name;
+	SkipRestOfName(instream);
 	instream >> ArrayOfOpAmps.PinCount;
 	instream >> ArrayOfOpAmps.SlewRate;
 	return instream;
 }
 
-// Class containing a pointer to OpAmp object,
-// also contains functions needed to operate the console.
-// Sort functions were not succesfully implemented, therefore are commented out
-class OpAmpDatabase
+// Memory used by one part of the database
+struct MemoryUsage
+{
+	const char *Name;		// the part of the database
+	unsigned long Used;		// the number of bytes holding data
+	unsigned long Reserved;	// the number of bytes set aside
+};
+
+// the largest number of parts of the database reporting their memory usage
+#define MEMORY_USAGE_MAX 4
+
+// Class handing out fixed size blocks of memory from a buffer set aside when the
+// pool is created. Released blocks are kept in a free list to be handed out again,
+// so no memory is allocated or released while the pool is in use and the whole
+// pool is released at once.
+class BlockPool
 {
 private:
-	OpAmps *ArrayOfOpAmps;	// Creating a pointer to an op amp object
-	unsigned long database_length;
+	struct FreeBlock
+	{
+		FreeBlock *Next;		// the next block in the free list
+	};
+
+	unsigned char *Buffer;		// the memory the blocks are taken from
+	unsigned long BlockSize;	// the size of each block in bytes
+	unsigned long BlockCount;	// the number of blocks in the pool
+	unsigned long BlocksUsed;	// the number of blocks handed out
+	FreeBlock *FreeList;		// the blocks not handed out
+
+	// a pool owns its buffer, so it cannot be copied
+	BlockPool(const BlockPool &) = delete;
+	BlockPool &operator=(const BlockPool &) = delete;
 
-	//member function prototypes
 public:
-	OpAmpDatabase(OpAmps*);	// Constructor function initialised
-	~OpAmpDatabase();		// Destructor
-	void Enter();
-	void Display();
-	void Save();
-	void Load();
-	//	void Sort();
-	//	int SortSlewRate(const void *First, const void* Second);
-	//	int SortName(const void *First, const void* Second);
+	BlockPool(unsigned long, unsigned long);	// constructor
+	~BlockPool();								// destructor
+
+	void *Allocate();
+	void Release(void *Block);
+
+	unsigned long GetFreeBlocks();	// provides access to the number of blocks not handed out
+	unsigned long GetUsed();		// provides access to the number of bytes handed out
+	unsigned long GetReserved();	// provides access to the size of the pool in bytes
 };
 
-//Construct and destructor functions of the OpAmpDatabase-class
-OpAmpDatabase::OpAmpDatabase(OpAmps* DatabasePointer)
+// Constructor and destructor functions
+BlockPool::BlockPool(unsigned long Size, unsigned long Count) // constructor definition of class-BlockPool with every block free
 {
-	ArrayOfOpAmps = DatabasePointer;
-	database_length = 0;
+	// every block must be able to hold the free list link and stay aligned
+	BlockSize = (max(Size, (unsigned long)sizeof(FreeBlock)) + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+	BlockCount = Count;
+	BlocksUsed = 0;
+	Buffer = new unsigned char[BlockSize * BlockCount];
+
+	// chain every block into the free list, in order of address
+	FreeList = NULL;
+	for (unsigned long i = BlockCount; i > 0; i--)
+	{
+		FreeBlock *Block = (FreeBlock *)(Buffer + (i - 1) * BlockSize);
+		Block->Next = FreeList;
+		FreeList = Block;
+	}
 }
 
-OpAmpDatabase::~OpAmpDatabase()
+BlockPool::~BlockPool() // destructor function definition, releases every block at once
 {
-	cout << ".Goodbye." << endl;
+	delete[] Buffer;
 }
 
-// the length of the fixed array to be used for database - must be at least one
-// and no greater the maximum value allowed in an unsigned long (see the file 
-// limits.h)
-#define DATABASE_MAX 10
+// Hand out a block from the pool
+// Arguments: None
+// Returns: the block, or NULL if every block has been handed out
+void *BlockPool::Allocate()
+{
+	if (FreeList == NULL)
+	{
+		return NULL;
+	}
 
-// file used for the database
-#define DATABASE_FILENAME "database.txt"
+	FreeBlock *Block = FreeList;
+	FreeList = Block->Next;
+	BlocksUsed++;
+	return Block;
+}
 
-// Control the entering, saving, loading, sorting and displaying of elements in 
-// the database
-// Arguments: None
-// Returns: 0 on completion
-int main()
+// Return a block to the pool
+// Arguments:
+//   (1) the block, which must have been handed out by this pool
+// Returns: void
+void BlockPool::Release(void *Block)
 {
-	OpAmps OpAmpArray[DATABASE_MAX];		// The database being created in a format of the array of op amp objects.
-	OpAmpDatabase TheDatabase(OpAmpArray);  // Creates an array of the database
+	FreeBlock *Released = (FreeBlock *)Block;
+	Released->Next = FreeList;
+	FreeList = Released;
+	BlocksUsed--;
+}
 
-	char UserInput;
+unsigned long BlockPool::GetFreeBlocks() // function to access private members of class-BlockPool
+{
+	return BlockCount - BlocksUsed;
+}
 
-	// loop until the user wishes to exit
-	while (1)
+unsigned long BlockPool::GetUsed() // function to access private members of class-BlockPool
+{
+	return BlocksUsed * BlockSize;
+}
+
+unsigned long BlockPool::GetReserved() // function to access private members of class-BlockPool
+{
+	return BlockCount * BlockSize;
+}
+
+// the number of partitions used by the query cache to track changes to the
+// database - op-amps are placed in a partition according to their pin count
+#define CACHE_PARTITIONS 16
+
+// the maximum number of query results held in the query cache
+#define CACHE_MAX 8
+
+// the number of bytes the query cache may use to hold query results
+#define CACHE_MEMORY_BUDGET 256
+
+// the number of positions of matching op-amps held in each block of a query result
+#define CACHE_BLOCK_RESULTS 4
+
+// Class holding the results of recent queries so that a repeated query does not
+// have to search the database again.
+// Every partition has a version counter which is increased whenever an op-amp in
+// that partition changes. A stored result remembers the version it was found with
+// and is only used again while that version is unchanged. Queries over any pin
+// count depend on the whole database and use a version covering all partitions.
+// Results are held in a chain of blocks from a pool of CACHE_MEMORY_BUDGET bytes.
+class QueryCache
+{
+private:
+	struct ResultBlock
 	{
-		// show the menu of options
-		cout << endl;
-		cout << "Op-amp database menu" << endl;
-		cout << "--------------------" << endl;
-		cout << "1. Enter a new op-amp into the database" << endl;
-		cout << "2. Save the database to disk" << endl;
-		cout << "3. Load the database from disk" << endl;
-		cout << "4. Sort the database" << endl;
-		cout << "5. Display the database" << endl;
-		cout << "6. Exit from the program" << endl << endl;
+		ResultBlock *Next;							// the next block of the result
+		unsigned long Positions[CACHE_BLOCK_RESULTS];	// positions of matching op-amps in the database
+	};
 
-		// get the user's choice
-		cout << "Enter your option: ";
-		cin >> UserInput;
-		cout << endl;
+	struct CacheEntry
+	{
+		unsigned int PinCount;		// the number of pins queried, 0 for any
+		double MinSlewRate;			// the minimum slew rate queried
+		unsigned long Version;		// the version of the partition when the result was stored
+		unsigned long LastUsed;		// when the entry was last used, to find the least recently used entry
+		ResultBlock *Results;		// the first block of positions of the matching op-amps
+		unsigned long ResultCount;	// the number of matching op-amps
+	};
 
-		// act on the user's input
-		switch (UserInput)
-		{
-		case '1':
-			TheDatabase.Enter();
-			break;
+	CacheEntry Entries[CACHE_MAX];					// the stored query results
+	unsigned long EntryCount;						// the number of stored query results
+	unsigned long PartitionVersion[CACHE_PARTITIONS];	// version counter of each partition
+	unsigned long DatabaseVersion;					// version counter of the whole database
+	unsigned long Clock;							// increased on every use of an entry
+	BlockPool Blocks;								// the blocks holding the query results
 
-		case '2':
-			TheDatabase.Save();
-			break;
+	unsigned long Hits;				// queries answered from the cache
+	unsigned long Misses;			// queries which had to search the database
+	unsigned long Evictions;		// entries removed to make space for new results
+	unsigned long Invalidations;	// entries removed because the database changed
 
-		case '3':
-			TheDatabase.Load();
-			break;
+	unsigned long CurrentVersion(unsigned int PinCount);
+	void Remove(unsigned long Position);
 
-		case '4':
-			//TheDatabase.Sort();
-			break;
+public:
+	QueryCache();				// constructor
 
-		case '5':
-			TheDatabase.Display();
-			break;
+	bool Lookup(unsigned int PinCount, double MinSlewRate, unsigned long *Results, unsigned long &ResultCount);
+	void Store(unsigned int PinCount, double MinSlewRate, const unsigned long *Results, unsigned long ResultCount);
+	void Invalidate(unsigned int PinCount);	// an op-amp with this pin count was changed
+	void InvalidateAll();					// the whole database was replaced
+	void DisplayStatistics();
+	void GetMemoryUsage(MemoryUsage &Usage);
+};
 
-		case '6':
-			return 0;
+// Constructor function
+QueryCache::QueryCache() : Blocks(sizeof(ResultBlock), CACHE_MEMORY_BUDGET / sizeof(ResultBlock)) // constructor definition of class-QueryCache with an empty cache
+{
+	EntryCount = 0;
+	for (unsigned long i = 0; i < CACHE_PARTITIONS; i++)
+	{
+		PartitionVersion[i] = 0;
+	}
+	DatabaseVersion = 0;
+	Clock = 0;
 
-		default:
-			cout << "Invalid entry" << endl << endl;
-			break;
+	Hits = 0;
+	Misses = 0;
+	Evictions = 0;
+	Invalidations = 0;
+}
+
+// Find the version a query result depends on. A query for a pin count only
+// depends on the partition holding that pin count.
+// Arguments:
+//   (1) the number of pins queried, 0 for any
+// Returns: the current version
+unsigned long QueryCache::CurrentVersion(unsigned int PinCount)
+{
+	if (PinCount == 0)
+	{
+		return DatabaseVersion;
+	}
+
+	return PartitionVersion[PinCount % CACHE_PARTITIONS];
+}
+
+// Remove an entry from the cache and return its blocks to the pool. The last
+// entry is moved into its place.
+// Arguments:
+//   (1) the position of the entry in the cache
+// Returns: void
+void QueryCache::Remove(unsigned long Position)
+{
+	ResultBlock *Block = Entries[Position].Results;
+	while (Block != NULL)
+	{
+		ResultBlock *Next = Block->Next;
+		Blocks.Release(Block);
+		Block = Next;
+	}
+
+	EntryCount--;
+	Entries[Position] = Entries[EntryCount];
+}
+
+// Look for the result of a query in the cache. A result found with an older
+// version of its partition is out of date and removed.
+// Arguments:
+//   (1) the number of pins queried, 0 for any
+//   (2) the minimum slew rate queried
+//   (3) filled with the positions of the matching op-amps
+//   (4) set to the number of matching op-amps
+// Returns: true if the result was found in the cache
+bool QueryCache::Lookup(unsigned int PinCount, double MinSlewRate, unsigned long *Results, unsigned long &ResultCount)
+{
+	for (unsigned long i = 0; i < EntryCount; i++)
+	{
+		if (Entries[i].PinCount == PinCount && Entries[i].MinSlewRate == MinSlewRate)
+		{
+			if (Entries[i].Version != CurrentVersion(PinCount))
+			{
+				Remove(i);
+				Invalidations++;
+				break;
+			}
+
+			Entries[i].LastUsed = ++Clock;
+			ResultCount = Entries[i].ResultCount;
+
+			ResultBlock *Block = Entries[i].Results;
+			for (unsigned long j = 0; j < ResultCount; j++)
+			{
+				if (j > 0 && j % CACHE_BLOCK_RESULTS == 0)
+				{
+					Block = Block->Next;
+				}
+				Results[j] = Block->Positions[j % CACHE_BLOCK_RESULTS];
+			}
+
+			Hits++;
+			return true;
 		}
 	}
+
+	Misses++;
+	return false;
 }
 
-// Allow the user to enter a new element into the database. Note that the data 
-// is simply added to the end the database (if not full) and no sorting is
-// carried out.
+// Store the result of a query in the cache. The least recently used entries are
+// removed until the result fits in the cache. A result larger than the whole
+// memory budget is not stored.
 // Arguments:
-//   (1) the element in the database to be entered
-//   (2) the position of the element in the database
+//   (1) the number of pins queried, 0 for any
+//   (2) the minimum slew rate queried
+//   (3) the positions of the matching op-amps
+//   (4) the number of matching op-amps
 // Returns: void
-void OpAmpDatabase::Enter()
+void QueryCache::Store(unsigned int PinCount, double MinSlewRate, const unsigned long *Results, unsigned long ResultCount)
 {
-	// if the database is full, inform the user
-	if (database_length == DATABASE_MAX)
+	unsigned long BlocksNeeded = (ResultCount + CACHE_BLOCK_RESULTS - 1) / CACHE_BLOCK_RESULTS;
+
+	if (BlocksNeeded * sizeof(ResultBlock) > CACHE_MEMORY_BUDGET)
 	{
-		cout << "The database is full" << endl;
+		return;
 	}
 
-	// if the database is not full, get the data from the user and alter the database
-	// length
-	else
+	// out of date entries are removed first, so that they are not kept in place
+	// of entries which can still be used
+	if (EntryCount == CACHE_MAX || Blocks.GetFreeBlocks() < BlocksNeeded)
 	{
-		ArrayOfOpAmps[database_length].SetOpAmpValues();
-		database_length++;
+		for (unsigned long i = EntryCount; i > 0; i--)
+		{
+			if (Entries[i - 1].Version != CurrentVersion(Entries[i - 1].PinCount))
+			{
+				Remove(i - 1);
+				Invalidations++;
+			}
+		}
+	}
+
+	while (EntryCount == CACHE_MAX || Blocks.GetFreeBlocks() < BlocksNeeded)
+	{
+		unsigned long Oldest = 0;
+		for (unsigned long i = 1; i < EntryCount; i++)
+		{
+			if (Entries[i].LastUsed < Entries[Oldest].LastUsed)
+			{
+				Oldest = i;
+			}
+		}
+
+		Remove(Oldest);
+		Evictions++;
+	}
+
+	CacheEntry &NewEntry = Entries[EntryCount];
+	NewEntry.PinCount = PinCount;
+	NewEntry.MinSlewRate = MinSlewRate;
+	NewEntry.Version = CurrentVersion(PinCount);
+	NewEntry.LastUsed = ++Clock;
+	NewEntry.Results = NULL;
+	NewEntry.ResultCount = ResultCount;
+
+	// copy the positions into a chain of blocks, filling the last block first
+	for (unsigned long i = BlocksNeeded; i > 0; i--)
+	{
+		ResultBlock *Block = (ResultBlock *)Blocks.Allocate();
+		unsigned long First = (i - 1) * CACHE_BLOCK_RESULTS;
+		unsigned long Last = min(First + CACHE_BLOCK_RESULTS, ResultCount);
+
+		copy(Results + First, Results + Last, Block->Positions);
+		Block->Next = NewEntry.Results;
+		NewEntry.Results = Block;
 	}
+
+	EntryCount++;
 }
 
-// Save the database to the file specified by DATABASE_FILENAME. If the file
-// exists it is simply overwritten without asking the user
+// Record that an op-amp was entered or removed. Only results depending on the
+// partition of the op-amp become out of date.
 // Arguments:
-//   (1) the database
-//   (2) the length of the database
+//   (1) the number of pins of the op-amp
 // Returns: void
-void OpAmpDatabase::Save()
+void QueryCache::Invalidate(unsigned int PinCount)
 {
-	fstream outstream;  // file stream for output
+	PartitionVersion[PinCount % CACHE_PARTITIONS]++;
+	DatabaseVersion++;
+}
 
-	outstream.open(DATABASE_FILENAME, ios::out); // open the file
+// Record that the whole database was replaced, every stored result is out of
+// date and removed.
+// Arguments: None
+// Returns: void
+void QueryCache::InvalidateAll()
+{
+	for (unsigned long i = 0; i < CACHE_PARTITIONS; i++)
+	{
+		PartitionVersion[i]++;
+	}
+	DatabaseVersion++;
 
-	outstream << database_length << endl << endl;
-	for (unsigned long i = 0; i < database_length; i++)
+	Invalidations += EntryCount;
+	while (EntryCount > 0)
 	{
-		outstream << ArrayOfOpAmps[i];
+		Remove(EntryCount - 1);
 	}
+}
 
-	outstream.close();
+// Display the number of hits, misses and evictions of the cache
+// Arguments: None
+// Returns: void
+void QueryCache::DisplayStatistics()
+{
+	cout << "Query cache" << endl;
+	cout << "-----------" << endl;
+	cout << "Entries:		" << EntryCount << " of " << CACHE_MAX << endl;
+	cout << "Memory used:		" << Blocks.GetUsed() << " of " << Blocks.GetReserved() << " bytes" << endl;
+	cout << "Hits:			" << Hits << endl;
+	cout << "Misses:			" << Misses << endl;
+	cout << "Evictions:		" << Evictions << endl;
+	cout << "Invalidations:		" << Invalidations << endl;
 }
 
-// Load the database from the file specified by DATABASE_FILENAME. If the file
-// exists it simply overwrites the data currently in memory without asking
-// the user
+// Find the memory used by the cache
 // Arguments:
-//   (1) the database
-//   (2) the length of the database
+//   (1) set to the memory used
 // Returns: void
-void OpAmpDatabase::Load()
+void QueryCache::GetMemoryUsage(MemoryUsage &Usage)
 {
-	ifstream instream;  // file stream for input
+	Usage.Name = "Query cache";
+	Usage.Used = EntryCount * sizeof(CacheEntry) + Blocks.GetUsed();
+	Usage.Reserved = sizeof(Entries) + Blocks.GetReserved();
+}
 
-	instream.open(DATABASE_FILENAME, ios::in);	 // open the file
+// the number of symbols three character sequences (trigrams) are made of - the
+// digits, the letters ignoring case, and one symbol for every other character
+#define NGRAM_ALPHABET 37
+#define NGRAM_TRIGRAMS (NGRAM_ALPHABET * NGRAM_ALPHABET * NGRAM_ALPHABET)
 
-	instream >> database_length;
-	for (unsigned long i = 0; i < database_length; i++)
+// the number of posting lists in the name index for each element of the database
+#define NGRAM_LISTS_PER_ELEMENT 4UL
+
+// the number of posting lists in the name index - a large database has a list for
+// every trigram, a small one shares lists between trigrams so that the lists stay
+// in proportion to the database
+#define NGRAM_LISTS (DATABASE_MAX * NGRAM_LISTS_PER_ELEMENT < NGRAM_TRIGRAMS ? \
+	DATABASE_MAX * NGRAM_LISTS_PER_ELEMENT : NGRAM_TRIGRAMS)
+
+// the number of bytes of a posting list held in each block
+#define NGRAM_BLOCK_BYTES 12
+
+// the most bytes needed to write a position in a posting list, seven bits to a byte
+#define NGRAM_POSITION_BYTES (DATABASE_MAX <= 0x80UL ? 1 : DATABASE_MAX <= 0x4000UL ? 2 : \
+	DATABASE_MAX <= 0x200000UL ? 3 : DATABASE_MAX <= 0x10000000UL ? 4 : 5)
+
+// the number of blocks in the pool holding the posting lists of the name index -
+// enough for every trigram of a full database of names of the longest length, plus
+// a part filled block per list, so the index cannot run out of blocks. The pool is
+// set aside for this worst case when the program starts, about 110 bytes for each
+// element a database of a million elements can hold.
+#define NGRAM_BLOCKS ((DATABASE_MAX * (OPAMP_NAME_MAX - 2) * NGRAM_POSITION_BYTES + NGRAM_BLOCK_BYTES - 1) / \
+	NGRAM_BLOCK_BYTES + NGRAM_LISTS)
+
+// the longest text that can be searched for in the names
+#define SEARCH_TEXT_MAX 64
+
+// Class indexing the names of the op-amps by the three character sequences
+// (trigrams) they contain, ignoring case. Each trigram has a posting list of the
+// positions of the names containing it. A posting list is held as the differences
+// between positions, each written in as few bytes as possible, in a chain of
+// blocks from a pool.
+// A search only looks at the names sharing enough trigrams with the search text.
+// If the pool runs out of blocks the index is incomplete and every name is
+// looked at.
+class NameIndex
+{
+private:
+	struct PostingBlock
 	{
-		instream >> ArrayOfOpAmps[i];
+		PostingBlock *Next;						// the next block of the list
+		unsigned char Bytes[NGRAM_BLOCK_BYTES];	// the encoded positions
+	};
+
+	struct PostingList
+	{
+		PostingBlock *First;		// the first block of the list
+		PostingBlock *Last;			// the block new positions are added to
+		unsigned long Length;		// the number of bytes in the list
+		unsigned long LastPosition;	// the last position added to the list
+	};
+
+	PostingList Lists[NGRAM_LISTS];		// the posting list of each trigram hash
+	unsigned long IndexedLength;		// the number of names indexed
+	bool Complete;						// false if a name could not be fully indexed
+	unsigned char Counts[DATABASE_MAX];	// trigrams shared with the search text by each name
+	BlockPool Blocks;					// the blocks holding the posting lists
+
+	unsigned long FindLists(const char *Text, unsigned long *TextLists, unsigned long Capacity);
+	bool AppendByte(PostingList &List, unsigned char Byte);
+
+public:
+	NameIndex();				// constructor
+
+	void Clear();
+	void Add(unsigned long Position, const char *Name);
+	unsigned long Search(const char *Text, unsigned long MaxEdits, unsigned long *Positions);
+
+	bool IsComplete();			// provides access to private Complete
+	void GetMemoryUsage(MemoryUsage &Usage);
+};
+
+// Constructor function
+NameIndex::NameIndex() : Blocks(sizeof(PostingBlock), NGRAM_BLOCKS) // constructor definition of class-NameIndex with no names indexed
+{
+	for (unsigned long i = 0; i < NGRAM_LISTS; i++)
+	{
+		Lists[i].First = NULL;
+		Lists[i].Last = NULL;
+		Lists[i].Length = 0;
+		Lists[i].LastPosition = 0;
 	}
+	IndexedLength = 0;
+	Complete = true;
+}
 
-	// close the file
-	instream.close();
+// Remove every name from the index and return the blocks to the pool
+// Arguments: None
+// Returns: void
+void NameIndex::Clear()
+{
+	for (unsigned long i = 0; i < NGRAM_LISTS; i++)
+	{
+		PostingBlock *Block = Lists[i].First;
+		while (Block != NULL)
+		{
+			PostingBlock *Next = Block->Next;
+			Blocks.Release(Block);
+			Block = Next;
+		}
+
+		Lists[i].First = NULL;
+		Lists[i].Last = NULL;
+		Lists[i].Length = 0;
+		Lists[i].LastPosition = 0;
+	}
+	IndexedLength = 0;
+	Complete = true;
+}
+
+// Find the symbol of the trigram alphabet a character belongs to
+// Arguments:
+//   (1) the character
+// Returns: the symbol, from 0 to NGRAM_ALPHABET - 1
+static unsigned long NgramSymbol(char Character)
+{
+	unsigned char Symbol = (unsigned char)toupper((unsigned char)Character);
+
+	if (Symbol >= '0' && Symbol <= '9')
+	{
+		return Symbol - '0';
+	}
+	if (Symbol >= 'A' && Symbol <= 'Z')
+	{
+		return 10 + Symbol - 'A';
+	}
+	return NGRAM_ALPHABET - 1;
+}
+
+// Find the posting lists of the distinct trigrams of a text
+// Arguments:
+//   (1) the text
+//   (2) filled with the lists
+//   (3) the number of lists which can be filled in
+// Returns: the number of lists, at most the capacity
+unsigned long NameIndex::FindLists(const char *Text, unsigned long *TextLists, unsigned long Capacity)
+{
+	unsigned long ListCount = 0;
+	size_t Length = strlen(Text);
+
+	for (size_t i = 0; i + 3 <= Length && ListCount < Capacity; i++)
+	{
+		unsigned long Hash = 0;
+		for (size_t j = i; j < i + 3; j++)
+		{
+			Hash = Hash * NGRAM_ALPHABET + NgramSymbol(Text[j]);
+		}
+		Hash %= NGRAM_LISTS;
+
+		// a trigram appearing twice is only counted once
+		if (find(TextLists, TextLists + ListCount, Hash) == TextLists + ListCount)
+		{
+			TextLists[ListCount++] = Hash;
+		}
+	}
+
+	return ListCount;
+}
+
+// Add a byte to the end of a posting list, taking a new block when the last is full
+// Arguments:
+//   (1) the posting list
+//   (2) the byte
+// Returns: false if the pool has no more blocks
+bool NameIndex::AppendByte(PostingList &List, unsigned char Byte)
+{
+	if (List.Length % NGRAM_BLOCK_BYTES == 0)
+	{
+		PostingBlock *Block = (PostingBlock *)Blocks.Allocate();
+		if (Block == NULL)
+		{
+			return false;
+		}
+
+		Block->Next = NULL;
+		if (List.Last == NULL)
+		{
+			List.First = Block;
+		}
+		else
+		{
+			List.Last->Next = Block;
+		}
+		List.Last = Block;
+	}
+
+	List.Last->Bytes[List.Length % NGRAM_BLOCK_BYTES] = Byte;
+	List.Length++;
+	return true;
+}
+
+// Add the name of the op-amp at the end of the database to the index. The
+// position is added to the posting list of each trigram of the name, as the
+// difference from the last position in the list in groups of seven bits.
+// Arguments:
+//   (1) the position of the op-amp in the database
+//   (2) the name of the op-amp
+// Returns: void
+void NameIndex::Add(unsigned long Position, const char *Name)
+{
+	unsigned long NameLists[OPAMP_NAME_MAX];
+	unsigned long ListCount = FindLists(Name, NameLists, OPAMP_NAME_MAX);
+
+	// a name too long to be held could not have all its trigrams added
+	if (strlen(Name) >= OPAMP_NAME_MAX)
+	{
+		Complete = false;
+	}
+
+	for (unsigned long i = 0; i < ListCount && Complete; i++)
+	{
+		PostingList &List = Lists[NameLists[i]];
+
+		// another trigram of this name may already have added it to the list
+		if (List.Length > 0 && List.LastPosition == Position)
+		{
+			continue;
+		}
+
+		unsigned long Difference = Position - List.LastPosition;
+		while (Complete && Difference >= 0x80)
+		{
+			Complete = AppendByte(List, (unsigned char)(Difference & 0x7F) | 0x80);
+			Difference >>= 7;
+		}
+		Complete = Complete && AppendByte(List, (unsigned char)Difference);
+		List.LastPosition = Position;
+	}
+
+	IndexedLength = Position + 1;
+}
+
+// Find the names which may contain a text, or which may be within a number of
+// edits (characters inserted, removed or changed) of the text. An edit changes at
+// most three trigrams, so such a name shares all but three trigrams per edit with
+// the text. The names found still have to be checked.
+// Arguments:
+//   (1) the text searched for, shorter than SEARCH_TEXT_MAX
+//   (2) the number of edits allowed, 0 to find names containing the text
+//   (3) filled with the positions of the names, must hold DATABASE_MAX positions
+// Returns: the number of positions
+unsigned long NameIndex::Search(const char *Text, unsigned long MaxEdits, unsigned long *Positions)
+{
+	unsigned long TextLists[SEARCH_TEXT_MAX];
+	unsigned long ListCount = FindLists(Text, TextLists, SEARCH_TEXT_MAX);
+	unsigned long PositionCount = 0;
+
+	// if the index cannot rule any name out, every name has to be checked
+	// written so that a large number of edits cannot overflow
+	if (!Complete || MaxEdits >= (ListCount + 2) / 3)
+	{
+		for (unsigned long i = 0; i < IndexedLength; i++)
+		{
+			Positions[PositionCount++] = i;
+		}
+		return PositionCount;
+	}
+
+	// count the lists each name appears in
+	fill(Counts, Counts + IndexedLength, 0);
+	for (unsigned long i = 0; i < ListCount; i++)
+	{
+		PostingList &List = Lists[TextLists[i]];
+		PostingBlock *Block = List.First;
+		unsigned long Position = 0;
+		unsigned long Difference = 0;
+		unsigned long Shift = 0;
+
+		for (unsigned long j = 0; j < List.Length; j++)
+		{
+			if (j > 0 && j % NGRAM_BLOCK_BYTES == 0)
+			{
+				Block = Block->Next;
+			}
+
+			unsigned char Byte = Block->Bytes[j % NGRAM_BLOCK_BYTES];
+			Difference |= (unsigned long)(Byte & 0x7F) << Shift;
+			Shift += 7;
+
+			if ((Byte & 0x80) == 0)
+			{
+				Position += Difference;
+				Counts[Position]++;
+				Difference = 0;
+				Shift = 0;
+			}
+		}
+	}
+
+	for (unsigned long i = 0; i < IndexedLength; i++)
+	{
+		// MaxEdits is less than a third of ListCount here, so this cannot overflow
+		if (Counts[i] + 3 * MaxEdits >= ListCount)
+		{
+			Positions[PositionCount++] = i;
+		}
+	}
+
+	return PositionCount;
+}
+
+bool NameIndex::IsComplete() // function to access private members of class-NameIndex
+{
+	return Complete;
+}
+
+// Find the memory used by the index
+// Arguments:
+//   (1) set to the memory used
+// Returns: void
+void NameIndex::GetMemoryUsage(MemoryUsage &Usage)
+{
+	Usage.Name = "Name index";
+	Usage.Used = sizeof(Lists) + sizeof(Counts) + Blocks.GetUsed();
+	Usage.Reserved = sizeof(Lists) + sizeof(Counts) + Blocks.GetReserved();
+}
+
+// the size of the buffer used to read files being imported
+#define IMPORT_BUFFER_SIZE 512
+
+// the longest record accepted in a file being imported, one line of a CSV file
+// or one object of a JSON file
+#define IMPORT_RECORD_MAX 128
+
+// the number of records passed between the stages of an import or export
+#define PIPELINE_BATCH 4
+
+// the range of pin counts accepted when importing
+#define PIN_COUNT_MIN 1
+#define PIN_COUNT_MAX 64
+
+// the longest member name of a JSON object which is looked at when importing
+#define JSON_KEY_MAX 16
+
+// A record of a file being imported, as it is passed from stage to stage. Only the
+// members of a JSON object which are imported are kept in the text of its record.
+struct ImportRecord
+{
+	char Text[IMPORT_RECORD_MAX];	// the text of the record as read from the file
+	unsigned long Length;			// the length of the text, may be more than was kept
+	unsigned long Bytes;			// the number of bytes of the file the record came from
+	char Name[IMPORT_RECORD_MAX];	// the name read from the text
+	long PinCount;					// the number of pins read from the text
+	double SlewRate;				// the slew rate read from the text
+};
+
+// Statistics of one stage of an import or export
+struct PipelineStage
+{
+	const char *Name;		// the name of the stage
+	const char *Unit;		// what the stage counts, records or buffers
+	unsigned long Count;	// the number of records passed on by the stage, or buffers read
+	unsigned long Bytes;	// the number of bytes passed on, read or written by the stage
+	double Seconds;			// the time spent in the stage, including waiting for the disk
+};
+
+// Read the wall clock, which also counts time spent waiting for the disk
+// Arguments: None
+// Returns: the time in seconds from an arbitrary start
+static double WallClock()
+{
+	return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Class splitting a CSV or JSON file into records. The file is read through a
+// fixed size buffer, so only one buffer and the current record are ever held in
+// memory. A CSV record is one line of the file, a JSON record is one object.
+// Members of a JSON object which are not imported, including nested objects and
+// arrays, are skipped, so they do not count towards the longest record accepted.
+class RecordReader
+{
+private:
+	ifstream &Input;				// the file being imported
+	bool Json;						// true for a JSON file, false for a CSV file
+	char Buffer[IMPORT_BUFFER_SIZE];	// the part of the file read so far
+	unsigned long Position;			// the next character of the buffer to be split
+	unsigned long Filled;			// the number of characters in the buffer
+
+	void Append(ImportRecord &Record, char Character);
+
+public:
+	PipelineStage ReadStage;		// statistics of reading the file
+	PipelineStage SplitStage;		// statistics of splitting the file into records
+
+	RecordReader(ifstream &, bool);	// constructor
+	bool Next(ImportRecord &Record);
+};
+
+// Constructor function
+RecordReader::RecordReader(ifstream &FileToRead, bool IsJson) : Input(FileToRead) // constructor definition of class-RecordReader with an empty buffer
+{
+	Json = IsJson;
+	Position = 0;
+	Filled = 0;
+
+	ReadStage.Name = "Read";
+	ReadStage.Unit = "buffers";
+	ReadStage.Count = 0;
+	ReadStage.Bytes = 0;
+	ReadStage.Seconds = 0;
+
+	SplitStage.Name = "Split";
+	SplitStage.Unit = "records";
+	SplitStage.Count = 0;
+	SplitStage.Bytes = 0;
+	SplitStage.Seconds = 0;
+}
+
+// Add a character to the text of a record. Characters past the longest record
+// accepted are counted but not kept.
+// Arguments:
+//   (1) the record
+//   (2) the character
+// Returns: void
+void RecordReader::Append(ImportRecord &Record, char Character)
+{
+	if (Record.Length < IMPORT_RECORD_MAX - 1)
+	{
+		Record.Text[Record.Length] = Character;
+		Record.Text[Record.Length + 1] = '\0';
+	}
+	Record.Length++;
+}
+
+// Check whether a member of a JSON object is one which is imported
+// Arguments:
+//   (1) the name of the member
+// Returns: true if the member is imported
+static bool IsImportedKey(const char *Key)
+{
+	return strcmp(Key, "name") == 0 || strcmp(Key, "pins") == 0 || strcmp(Key, "slewrate") == 0;
+}
+
+// Split the next record from the file, reading more of the file into the buffer
+// when it has all been split.
+// Arguments:
+//   (1) set to the next record
+// Returns: false if there are no more records in the file
+bool RecordReader::Next(ImportRecord &Record)
+{
+	double Start = WallClock();
+	double ReadSeconds = 0;
+	bool Found = false;
+
+	// the state of a JSON file
+	unsigned long Depth = 0;	// the number of objects and arrays the character is inside, from the record
+	bool InString = false;		// braces inside a string do not start or end an object
+	bool Escaped = false;		// the last character was a backslash inside a string
+	bool AtKey = false;			// the next string of the record is the name of a member
+	bool ReadingKey = false;	// the string being read is the name of a member
+	bool Keep = false;			// the member being read is imported
+	char Key[JSON_KEY_MAX];		// the name of the member being read
+	unsigned long KeyLength = 0;
+
+	Record.Text[0] = '\0';
+	Record.Length = 0;
+	Record.Bytes = 0;
+
+	while (!Found)
+	{
+		// read the next part of the file once the buffer is used up
+		if (Position == Filled)
+		{
+			double ReadStart = WallClock();
+			Input.read(Buffer, IMPORT_BUFFER_SIZE);
+			Filled = (unsigned long)Input.gcount();
+			Position = 0;
+			ReadSeconds += WallClock() - ReadStart;
+			ReadStage.Bytes += Filled;
+
+			if (Filled == 0)
+			{
+				// the last line of a CSV file need not end with a new line
+				Found = !Json && Record.Length > 0;
+				break;
+			}
+			ReadStage.Count++;
+		}
+
+		char Character = Buffer[Position++];
+
+		if (!Json)
+		{
+			if (Character == '\n')
+			{
+				Found = Record.Length > 0;	// blank lines are skipped
+			}
+			else if (Character != '\r')
+			{
+				Append(Record, Character);
+				Record.Bytes++;
+			}
+			continue;
+		}
+
+		if (Depth > 0)
+		{
+			Record.Bytes++;
+		}
+
+		if (InString)
+		{
+			if (Escaped)
+			{
+				Escaped = false;
+			}
+			else if (Character == '\\')
+			{
+				Escaped = true;
+			}
+			else if (Character == '"')
+			{
+				InString = false;
+			}
+
+			if (ReadingKey)
+			{
+				if (InString)
+				{
+					// a name too long to be imported is kept too long to match
+					if (KeyLength < JSON_KEY_MAX - 1)
+					{
+						Key[KeyLength++] = Character;
+					}
+					continue;
+				}
+
+				// the name is complete, keep it if the member is imported
+				ReadingKey = false;
+				Key[KeyLength] = '\0';
+				Keep = IsImportedKey(Key);
+				if (Keep)
+				{
+					if (Record.Length > 0)
+					{
+						Append(Record, ',');
+					}
+					Append(Record, '"');
+					for (unsigned long i = 0; i < KeyLength; i++)
+					{
+						Append(Record, Key[i]);
+					}
+					Append(Record, '"');
+				}
+			}
+			else if (Depth == 1 && Keep)
+			{
+				Append(Record, Character);
+			}
+		}
+		else if (Character == '"')
+		{
+			InString = true;
+			if (Depth == 1 && AtKey)
+			{
+				AtKey = false;
+				ReadingKey = true;
+				KeyLength = 0;
+			}
+			else if (Depth == 1 && Keep)
+			{
+				Append(Record, Character);
+			}
+		}
+		else if (Character == '{' && Depth == 0)
+		{
+			// a new record
+			Depth = 1;
+			AtKey = true;
+			Keep = false;
+			Record.Text[0] = '\0';
+			Record.Length = 0;
+			Record.Bytes = 1;
+		}
+		else if (Depth == 0)
+		{
+			// between records, such as the array holding them
+		}
+		else if (Character == '{' || Character == '[')
+		{
+			Depth++;
+		}
+		else if (Character == '}' || Character == ']')
+		{
+			Depth--;
+			Found = Depth == 0;
+		}
+		else if (Depth == 1 && Character == ',')
+		{
+			AtKey = true;
+			Keep = false;
+		}
+		else if (Depth == 1 && Keep)
+		{
+			Append(Record, Character);
+		}
+	}
+
+	ReadStage.Seconds += ReadSeconds;
+	SplitStage.Seconds += WallClock() - Start - ReadSeconds;
+	if (Found)
+	{
+		SplitStage.Count++;
+		SplitStage.Bytes += Record.Bytes;
+	}
+
+	return Found;
+}
+
+// Class containing a pointer to OpAmp object,
+// also contains functions needed to operate the console.
+// Sort functions were not succesfully implemented, therefore are commented out
+class OpAmpDatabase
+{
+private:
+	OpAmps *ArrayOfOpAmps;	// Creating a pointer to an op amp object
+	unsigned long database_length;
+	QueryCache Cache;		// results of recent queries
+	NameIndex Names;		// index of the names for searching
+
+	bool IsMatch(unsigned long Position, unsigned int PinCount, double MinSlewRate);
+	void QueryByPins();
+	void SearchName(bool Similar);
+	unsigned long BulkEnter(OpAmps *Batch, unsigned long BatchLength);
+	void Import(const char *FileName, bool Json);
+	void Export(ostream &outstream, bool Json, unsigned int PinCount, double MinSlewRate);
+
+	//member function prototypes
+public:
+	OpAmpDatabase(OpAmps*);	// Constructor function initialised
+	~OpAmpDatabase();		// Destructor
+	void Enter();
+	void Display();
+	void Save();
+	void Load();
+	void Query();
+	void Statistics();
+	void ImportExport();
+	unsigned long GetMemoryUsage(MemoryUsage *Usage);
+	//	void Sort();
+	//	int SortSlewRate(const void *First, const void* Second);
+	//	int SortName(const void *First, const void* Second);
+};
+
+//Construct and destructor functions of the OpAmpDatabase-class
+OpAmpDatabase::OpAmpDatabase(OpAmps* DatabasePointer)
+{
+	ArrayOfOpAmps = DatabasePointer;
+	database_length = 0;
+}
+
+OpAmpDatabase::~OpAmpDatabase()
+{
+	cout << ".Goodbye." << endl;
+}
+
+// file used for the database
+#define DATABASE_FILENAME "database.txt"
+
+// Control the entering, saving, loading, sorting and displaying of elements in 
+// the database
+// Arguments: None
+// Returns: 0 on completion
+int main()
+{
+	OpAmps OpAmpArray[DATABASE_MAX];		// The database being created in a format of the array of op amp objects.
+	OpAmpDatabase TheDatabase(OpAmpArray);  // Creates an array of the database
+
+	char UserInput;
+
+	// loop until the user wishes to exit
+	while (1)
+	{
+		// show the menu of options
+		cout << endl;
+		cout << "Op-amp database menu" << endl;
+		cout << "--------------------" << endl;
+		cout << "1. Enter a new op-amp into the database" << endl;
+		cout << "2. Save the database to disk" << endl;
+		cout << "3. Load the database from disk" << endl;
+		cout << "4. Sort the database" << endl;
+		cout << "5. Display the database" << endl;
+		cout << "6. Exit from the program" << endl;
+		cout << "7. Query the database" << endl;
+		cout << "8. Display database statistics" << endl;
+		cout << "9. Import or export the database" << endl << endl;
+
+		// get the user's choice
+		cout << "Enter your option: ";
+		cin >> UserInput;
+		cout << endl;
+
+		// act on the user's input
+		switch (UserInput)
+		{
+		case '1':
+			TheDatabase.Enter();
+			break;
+
+		case '2':
+			TheDatabase.Save();
+			break;
+
+		case '3':
+			TheDatabase.Load();
+			break;
+
+		case '4':
+			//TheDatabase.Sort();
+			break;
+
+		case '5':
+			TheDatabase.Display();
+			break;
+
+		case '6':
+			return 0;
+
+		case '7':
+			TheDatabase.Query();
+			break;
+
+		case '8':
+			TheDatabase.Statistics();
+			break;
+
+		case '9':
+			TheDatabase.ImportExport();
+			break;
+
+		default:
+			cout << "Invalid entry" << endl << endl;
+			break;
+		}
+	}
+}
+
+// Allow the user to enter a new element into the database. Note that the data 
+// is simply added to the end the database (if not full) and no sorting is
+// carried out.
+// Arguments:
+//   (1) the element in the database to be entered
+//   (2) the position of the element in the database
+// Returns: void
+void OpAmpDatabase::Enter()
+{
+	// if the database is full, inform the user
+	if (database_length == DATABASE_MAX)
+	{
+		cout << "The database is full" << endl;
+	}
+
+	// if the database is not full, get the data from the user and alter the database
+	// length
+	else
+	{
+		ArrayOfOpAmps[database_length].SetOpAmpValues();
+		Cache.Invalidate(ArrayOfOpAmps[database_length].GetPinCountOpAmp());
+		Names.Add(database_length, ArrayOfOpAmps[database_length].GetNameOpAmp());
+		database_length++;
+	}
+}
+
+// Save the database to the file specified by DATABASE_FILENAME. If the file
+// exists it is simply overwritten without asking the user
+// Arguments:
+//   (1) the database
+//   (2) the length of the database
+// Returns: void
+void OpAmpDatabase::Save()
+{
+	fstream outstream;  // file stream for output
+
+	outstream.open(DATABASE_FILENAME, ios::out); // open the file
+
+	outstream << database_length << endl << endl;
+	for (unsigned long i = 0; i < database_length; i++)
+	{
+		outstream << ArrayOfOpAmps[i];
+	}
+
+	outstream.close();
+}
+
+// Load the database from the file specified by DATABASE_FILENAME. If the file
+// exists it simply overwrites the data currently in memory without asking
+// the user
+// Arguments:
+//   (1) the database
+//   (2) the length of the database
+// Returns: void
+void OpAmpDatabase::Load()
+{
+	ifstream instream;  // file stream for input
+
+	instream.open(DATABASE_FILENAME, ios::in);	 // open the file
+
+	instream >> database_length;
+	for (unsigned long i = 0; i < database_length; i++)
+	{
+		instream >> ArrayOfOpAmps[i];
+	}
+
+	// close the file
+	instream.close();
+
+	// the loaded data replaces everything the stored query results were found in
+	// and the name index is built again
+	Cache.InvalidateAll();
+	Names.Clear();
+	for (unsigned long i = 0; i < database_length; i++)
+	{
+		Names.Add(i, ArrayOfOpAmps[i].GetNameOpAmp());
+	}
 }
 
 // //Sort the database either using the name of the op-amps or using the slew rate
@@ -342,52 +1436,1012 @@ void OpAmpDatabase::Load()
 //	}
 //}
 
-//// Compare function for SORT (C++), to help sort the elements by the Name member of 
-//// OpAmps.
-//// Items should be sorted in alphabetical order.
-//// Arguments:
-////   (1) a database item
-////   (2) a database item
-//// Returns: result of the comparison
-//int OpAmpDatabase::SortName(const void *First, const void* Second)
-//{
-//	return strcmp(((OpAmps *)First)->GetNameOpAmp, ((OpAmps *)Second)->GetNameOpAmp);
-//}
+//// Compare function for SORT (C++), to help sort the elements by the Name member of 
+//// OpAmps.
+//// Items should be sorted in alphabetical order.
+//// Arguments:
+////   (1) a database item
+////   (2) a database item
+//// Returns: result of the comparison
+//int OpAmpDatabase::SortName(const void *First, const void* Second)
+//{
+//	return strcmp(((OpAmps *)First)->GetNameOpAmp, ((OpAmps *)Second)->GetNameOpAmp);
+//}
+
+//// Compare function for SORT (C++), to help sort the elements by the SlewRate member 
+//// of OpAmps.
+//// Items should be sorted in increasing value of slew rate.
+//// Arguments:
+////   (1) a database item
+////   (2) a database item
+//// Returns: result of the comparison
+//int OpAmpDatabase::SortSlewRate(const void *First, const void* Second)
+//{
+//	return (double)((((OpAmps *)First)->GetSlewRateOpAmp > ((OpAmps *)Second)->GetSlewRateOpAmp) ? 1 : -1);
+//}
+
+
+// Display all of the messages in the database.
+// Arguments:
+//   (1) the database
+//   (2) the length of the database
+// Returns: void
+
+void OpAmpDatabase::Display()
+{
+	// if the database is empty, display an error statement
+	if (database_length == 0)
+	{
+		cout << "No elements in the database" << endl;
+	}
+
+	// if the database is not empty, display all the elements in the database
+	else
+	{
+		cout << endl;
+		for (unsigned long i = 0; i < database_length; i++)
+		{
+			ArrayOfOpAmps[i].DisplayOpAmpValues(); //display current op amps contained in the database
+		}
+	}
+}
+
+// Check whether an op-amp in the database matches a query
+// Arguments:
+//   (1) the position of the op-amp in the database
+//   (2) the number of pins queried, 0 for any
+//   (3) the minimum slew rate queried
+// Returns: true if the op-amp matches
+bool OpAmpDatabase::IsMatch(unsigned long Position, unsigned int PinCount, double MinSlewRate)
+{
+	return (PinCount == 0 || ArrayOfOpAmps[Position].GetPinCountOpAmp() == (int)PinCount) &&
+		ArrayOfOpAmps[Position].GetSlewRateOpAmp() >= MinSlewRate;
+}
+
+// Query the database either by the number of pins and slew rate or by name
+// Arguments: None
+// Returns: void
+void OpAmpDatabase::Query()
+{
+	char UserInput;
+
+	// show the menu of options
+	cout << endl;
+	cout << "Query options" << endl;
+	cout << "-------------" << endl;
+	cout << "1. By number of pins and slew rate" << endl;
+	cout << "2. By part of the name" << endl;
+	cout << "3. By similar name" << endl;
+	cout << "4. Cancel" << endl << endl;
+
+	// get the user's choice of query
+	cout << "Enter your option: ";
+	cin >> UserInput;
+	cout << endl;
+
+	// act on the user's input
+	switch (UserInput)
+	{
+	case '1':
+		QueryByPins();
+		break;
+
+	case '2':
+		SearchName(false);
+		break;
+
+	case '3':
+		SearchName(true);
+		break;
+
+	case '4':
+		return;
+
+	default:
+		cout << "Invalid entry" << endl << endl;
+		break;
+	}
+}
+
+// Find the op-amps with a given number of pins and at least a given slew rate.
+// Repeated queries are answered from the query cache while the op-amps they
+// depend on are unchanged.
+// Arguments: None
+// Returns: void
+void OpAmpDatabase::QueryByPins()
+{
+	unsigned int PinCount;
+	double MinSlewRate;
+
+	cout << "Enter number of pins (0 for any): ";
+	cin >> PinCount;
+	cout << "Enter minimum slew rate: ";
+	cin >> MinSlewRate;
+	cout << endl;
+
+	// -0 and 0 are the same query
+	if (MinSlewRate == 0)
+	{
+		MinSlewRate = 0;
+	}
+
+	unsigned long Matches[DATABASE_MAX];	// positions of the matching op-amps
+	unsigned long ResultCount;
+
+	// if the query is not in the cache, search the database and store the result
+	if (!Cache.Lookup(PinCount, MinSlewRate, Matches, ResultCount))
+	{
+		ResultCount = 0;
+		for (unsigned long i = 0; i < database_length; i++)
+		{
+			if (IsMatch(i, PinCount, MinSlewRate))
+			{
+				Matches[ResultCount++] = i;
+			}
+		}
+
+		Cache.Store(PinCount, MinSlewRate, Matches, ResultCount);
+	}
+
+	if (ResultCount == 0)
+	{
+		cout << "No matching elements in the database" << endl;
+	}
+	else
+	{
+		for (unsigned long i = 0; i < ResultCount; i++)
+		{
+			ArrayOfOpAmps[Matches[i]].DisplayOpAmpValues();
+		}
+	}
+}
+
+// Find the memory used by each part of the database. The names are held within
+// the elements, so the memory of the names is left out of the elements and the
+// parts can be added up.
+// Arguments:
+//   (1) filled with the memory used by each part, must hold MEMORY_USAGE_MAX parts
+// Returns: the number of parts
+unsigned long OpAmpDatabase::GetMemoryUsage(MemoryUsage *Usage)
+{
+	unsigned long Parts = 0;
+
+	Usage[Parts].Name = "Elements";
+	Usage[Parts].Used = database_length * (sizeof(OpAmps) - OPAMP_NAME_MAX);
+	Usage[Parts].Reserved = DATABASE_MAX * (sizeof(OpAmps) - OPAMP_NAME_MAX);
+	Parts++;
+
+	Usage[Parts].Name = "Names";
+	Usage[Parts].Used = 0;
+	for (unsigned long i = 0; i < database_length; i++)
+	{
+		Usage[Parts].Used += strlen(ArrayOfOpAmps[i].GetNameOpAmp()) + 1;
+	}
+	Usage[Parts].Reserved = DATABASE_MAX * OPAMP_NAME_MAX;
+	Parts++;
+
+	Cache.GetMemoryUsage(Usage[Parts]);
+	Parts++;
+
+	Names.GetMemoryUsage(Usage[Parts]);
+	Parts++;
+
+	return Parts;
+}
+
+// Display statistics about the database, its memory usage and the query cache
+// Arguments: None
+// Returns: void
+void OpAmpDatabase::Statistics()
+{
+	MemoryUsage Usage[MEMORY_USAGE_MAX];
+	unsigned long Parts = GetMemoryUsage(Usage);
+
+	cout << "Database statistics" << endl;
+	cout << "-------------------" << endl;
+	cout << "Elements:		" << database_length << " of " << DATABASE_MAX << endl;
+	cout << endl;
+
+	cout << "Memory usage (bytes)" << endl;
+	cout << "--------------------" << endl;
+	cout << "Part		Used	Reserved" << endl;
+	unsigned long TotalUsed = 0;
+	unsigned long TotalReserved = 0;
+	for (unsigned long i = 0; i < Parts; i++)
+	{
+		cout << Usage[i].Name << "	" << (strlen(Usage[i].Name) < 8 ? "	" : "");
+		cout << Usage[i].Used << "	";
+		cout << Usage[i].Reserved << endl;
+
+		TotalUsed += Usage[i].Used;
+		TotalReserved += Usage[i].Reserved;
+	}
+	cout << "Total		" << TotalUsed << "	" << TotalReserved << endl;
+	if (!Names.IsComplete())
+	{
+		cout << "The name index is full, searches look at every name" << endl;
+	}
+	cout << endl;
+
+	Cache.DisplayStatistics();
+}
+
+// Add a batch of op-amps to the end of the database. Op-amps which do not fit in
+// the database are not added.
+// Arguments:
+//   (1) the op-amps to be added
+//   (2) the number of op-amps to be added
+// Returns: the number of op-amps added
+unsigned long OpAmpDatabase::BulkEnter(OpAmps *Batch, unsigned long BatchLength)
+{
+	unsigned long Added = 0;
+
+	while (Added < BatchLength && database_length < DATABASE_MAX)
+	{
+		ArrayOfOpAmps[database_length] = Batch[Added];
+		Cache.Invalidate(ArrayOfOpAmps[database_length].GetPinCountOpAmp());
+		Names.Add(database_length, ArrayOfOpAmps[database_length].GetNameOpAmp());
+		database_length++;
+		Added++;
+	}
+
+	return Added;
+}
+
+// Remove the spaces around a field of a record
+// Arguments:
+//   (1) the field, which is changed
+// Returns: the start of the field
+static char *TrimField(char *Field)
+{
+	while (isspace((unsigned char)*Field))
+	{
+		Field++;
+	}
+
+	char *End = Field + strlen(Field);
+	while (End > Field && isspace((unsigned char)*(End - 1)))
+	{
+		End--;
+	}
+	*End = '\0';
+
+	return Field;
+}
+
+// Parse a record of a CSV file in the form: name,pins,slew rate
+// A name containing commas or quotes is quoted, with each quote in it doubled.
+// Arguments:
+//   (1) the record
+// Returns: true if the record could be parsed
+static bool ParseCsvRecord(ImportRecord &Record)
+{
+	char Fields[IMPORT_RECORD_MAX];
+	const char *Text = Record.Text;
+	char *End;
+
+	while (isspace((unsigned char)*Text))
+	{
+		Text++;
+	}
+
+	// read the name up to the comma after it
+	if (*Text == '"')
+	{
+		size_t NameLength = 0;
+
+		Text++;
+		while (*Text != '"' || Text[1] == '"')
+		{
+			if (*Text == '\0')
+			{
+				return false;
+			}
+			if (*Text == '"')
+			{
+				Text++;
+			}
+			Record.Name[NameLength++] = *Text++;
+		}
+		Record.Name[NameLength] = '\0';
+
+		Text++;
+		while (isspace((unsigned char)*Text))
+		{
+			Text++;
+		}
+		if (*Text != ',')
+		{
+			return false;
+		}
+	}
+	else
+	{
+		const char *Comma = strchr(Text, ',');
+		if (Comma == NULL)
+		{
+			return false;
+		}
+
+		memcpy(Fields, Text, Comma - Text);
+		Fields[Comma - Text] = '\0';
+		strcpy(Record.Name, TrimField(Fields));
+		Text = Comma;
+	}
+
+	// split the rest of the record at the comma
+	strcpy(Fields, Text + 1);
+	char *SlewRate = strchr(Fields, ',');
+	if (SlewRate == NULL)
+	{
+		return false;
+	}
+	*SlewRate++ = '\0';
+	if (strchr(SlewRate, ',') != NULL)
+	{
+		return false;
+	}
+
+	char *PinCount = TrimField(Fields);
+	Record.PinCount = strtol(PinCount, &End, 10);
+	if (End == PinCount || *End != '\0')
+	{
+		return false;
+	}
+
+	SlewRate = TrimField(SlewRate);
+	Record.SlewRate = strtod(SlewRate, &End);
+	if (End == SlewRate || *End != '\0')
+	{
+		return false;
+	}
+
+	return true;
+}
+
+// Find the value of a member of a JSON object
+// Arguments:
+//   (1) the text of the object
+//   (2) the name of the member
+// Returns: the start of the value, or NULL if the member is not found
+static const char *FindJsonValue(const char *Text, const char *Key)
+{
+	size_t KeyLength = strlen(Key);
+	bool AtKey = true;		// the next string is the name of a member
+	bool InString = false;	// the character is inside a string
+	bool Escaped = false;	// the last character was a backslash inside a string
+
+	// only strings in the place of a member name are compared with the key
+	for (const char *Character = Text; *Character != '\0'; Character++)
+	{
+		if (InString)
+		{
+			if (Escaped)
+			{
+				Escaped = false;
+			}
+			else if (*Character == '\\')
+			{
+				Escaped = true;
+			}
+			else if (*Character == '"')
+			{
+				InString = false;
+			}
+		}
+		else if (*Character == '"')
+		{
+			if (AtKey && strncmp(Character + 1, Key, KeyLength) == 0 && Character[KeyLength + 1] == '"')
+			{
+				const char *Value = Character + KeyLength + 2;
+				while (isspace((unsigned char)*Value))
+				{
+					Value++;
+				}
+				if (*Value != ':')
+				{
+					return NULL;
+				}
+				Value++;
+				while (isspace((unsigned char)*Value))
+				{
+					Value++;
+				}
+				return Value;
+			}
+			InString = true;
+		}
+		else if (*Character == ':')
+		{
+			AtKey = false;
+		}
+		else if (*Character == ',')
+		{
+			AtKey = true;
+		}
+	}
+
+	return NULL;
+}
 
-//// Compare function for SORT (C++), to help sort the elements by the SlewRate member 
-//// of OpAmps.
-//// Items should be sorted in increasing value of slew rate.
-//// Arguments:
-////   (1) a database item
-////   (2) a database item
-//// Returns: result of the comparison
-//int OpAmpDatabase::SortSlewRate(const void *First, const void* Second)
-//{
-//	return (double)((((OpAmps *)First)->GetSlewRateOpAmp > ((OpAmps *)Second)->GetSlewRateOpAmp) ? 1 : -1);
-//}
+// Check that a number in a JSON object is followed by the end of its value
+// Arguments:
+//   (1) the character after the number
+// Returns: true if the number is complete
+static bool IsJsonValueEnd(char Character)
+{
+	return Character == ',' || Character == '}' || Character == '\0' || isspace((unsigned char)Character);
+}
+
+// Parse a record of a JSON file in the form:
+// {"name": "741", "pins": 8, "slewrate": 0.5}
+// The name may contain the escapes \" \\ and \/, other escapes are not accepted.
+// Arguments:
+//   (1) the record
+// Returns: true if the record could be parsed
+static bool ParseJsonRecord(ImportRecord &Record)
+{
+	const char *Value;
+	char *End;
 
+	Value = FindJsonValue(Record.Text, "name");
+	if (Value == NULL || *Value != '"')
+	{
+		return false;
+	}
+	Value++;
 
-// Display all of the messages in the database.
+	size_t NameLength = 0;
+	while (*Value != '"')
+	{
+		if (*Value == '\0')
+		{
+			return false;
+		}
+		if (*Value == '\\')
+		{
+			Value++;
+			if (*Value != '"' && *Value != '\\' && *Value != '/')
+			{
+				return false;
+			}
+		}
+		Record.Name[NameLength++] = *Value++;
+	}
+	Record.Name[NameLength] = '\0';
+
+	Value = FindJsonValue(Record.Text, "pins");
+	if (Value == NULL)
+	{
+		return false;
+	}
+	Record.PinCount = strtol(Value, &End, 10);
+	if (End == Value || !IsJsonValueEnd(*End))
+	{
+		return false;
+	}
+
+	Value = FindJsonValue(Record.Text, "slewrate");
+	if (Value == NULL)
+	{
+		return false;
+	}
+	Record.SlewRate = strtod(Value, &End);
+	if (End == Value || !IsJsonValueEnd(*End))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+// Check that a parsed record can be held in the database. The name must fit and
+// must not contain spaces, as it is saved to the database file as a single word.
 // Arguments:
-//   (1) the database
-//   (2) the length of the database
+//   (1) the record
+// Returns: true if the record is valid
+static bool ValidateRecord(const ImportRecord &Record)
+{
+	size_t NameLength = strlen(Record.Name);
+	if (NameLength == 0 || NameLength >= OPAMP_NAME_MAX)
+	{
+		return false;
+	}
+	for (size_t i = 0; i < NameLength; i++)
+	{
+		if (!isgraph((unsigned char)Record.Name[i]))
+		{
+			return false;
+		}
+	}
+
+	if (Record.PinCount < PIN_COUNT_MIN || Record.PinCount > PIN_COUNT_MAX)
+	{
+		return false;
+	}
+
+	// also rejects a slew rate which is not a number, or too large to be written
+	// and read back such as 1e400
+	return isfinite(Record.SlewRate) && Record.SlewRate >= 0;
+}
+
+// Display the statistics of the stages of an import or export
+// Arguments:
+//   (1) the stages
+//   (2) the number of stages
 // Returns: void
+static void DisplayPipelineStages(const PipelineStage *Stages, unsigned long StageCount)
+{
+	cout << endl;
+	cout << "Stage		Count		Bytes	Seconds	Bytes per second" << endl;
+	for (unsigned long i = 0; i < StageCount; i++)
+	{
+		double Seconds = Stages[i].Seconds;
 
-void OpAmpDatabase::Display()
+		cout << Stages[i].Name << "	" << (strlen(Stages[i].Name) < 8 ? "	" : "");
+		cout << Stages[i].Count << " " << Stages[i].Unit << "	";
+		cout << Stages[i].Bytes << "	";
+		cout << Seconds << "	";
+		if (Seconds > 0)
+		{
+			cout << Stages[i].Bytes / Seconds;
+		}
+		else
+		{
+			cout << "-";
+		}
+		cout << endl;
+	}
+}
+
+// Import op-amps from a CSV or JSON file and add them to the end of the database.
+// The file passes through the stages: read, split into records, parse, validate
+// and insert, a batch of records at a time. Records which cannot be parsed or are
+// not valid are skipped.
+// Arguments:
+//   (1) the name of the file
+//   (2) true for a JSON file, false for a CSV file
+// Returns: void
+void OpAmpDatabase::Import(const char *FileName, bool Json)
 {
-	// if the database is empty, display an error statement
-	if (database_length == 0)
+	ifstream instream;  // file stream for input
+
+	instream.open(FileName, ios::in | ios::binary);	// open the file
+
+	if (!instream.good())
 	{
-		cout << "No elements in the database" << endl;
+		cerr << "ERROR: Could not open file " << FileName << endl;
+		return;
 	}
 
-	// if the database is not empty, display all the elements in the database
-	else
+	RecordReader Reader(instream, Json);
+	PipelineStage Parse = { "Parse", "records", 0, 0, 0.0 };
+	PipelineStage Validate = { "Validate", "records", 0, 0, 0.0 };
+	PipelineStage Insert = { "Insert", "records", 0, 0, 0.0 };
+
+	ImportRecord Records[PIPELINE_BATCH];	// records passed from stage to stage
+	bool Parsed[PIPELINE_BATCH];			// whether each record could be parsed
+	OpAmps Batch[PIPELINE_BATCH];			// valid op-amps waiting to be inserted
+	unsigned long BatchBytes[PIPELINE_BATCH];	// the bytes of the record of each valid op-amp
+	bool FirstRecord = true;				// the first line of a CSV file may be a header
+	unsigned long TooLong = 0;
+	unsigned long Rejected = 0;
+	unsigned long NotAdded = 0;
+
+	while (1)
 	{
-		cout << endl;
-		for (unsigned long i = 0; i < database_length; i++)
+		// split a batch of records from the file
+		unsigned long BatchLength = 0;
+		while (BatchLength < PIPELINE_BATCH && Reader.Next(Records[BatchLength]))
 		{
-			ArrayOfOpAmps[i].DisplayOpAmpValues(); //display current op amps contained in the database
+			BatchLength++;
+		}
+		if (BatchLength == 0)
+		{
+			break;
+		}
+
+		// parse the fields of the records
+		double Start = WallClock();
+		for (unsigned long i = 0; i < BatchLength; i++)
+		{
+			if (Records[i].Length >= IMPORT_RECORD_MAX)
+			{
+				Parsed[i] = false;
+				TooLong++;
+			}
+			else
+			{
+				Parsed[i] = Json ? ParseJsonRecord(Records[i]) : ParseCsvRecord(Records[i]);
+
+				if (Parsed[i])
+				{
+					Parse.Count++;
+					Parse.Bytes += Records[i].Bytes;
+				}
+				else if (!(FirstRecord && !Json))
+				{
+					Rejected++;
+				}
+			}
+			FirstRecord = false;
+		}
+		Parse.Seconds += WallClock() - Start;
+
+		// keep the valid records
+		Start = WallClock();
+		unsigned long ValidLength = 0;
+		for (unsigned long i = 0; i < BatchLength; i++)
+		{
+			if (!Parsed[i])
+			{
+				continue;
+			}
+
+			if (ValidateRecord(Records[i]))
+			{
+				Batch[ValidLength].SetOpAmpValues(Records[i].Name, (unsigned int)Records[i].PinCount, Records[i].SlewRate);
+				BatchBytes[ValidLength] = Records[i].Bytes;
+				Validate.Bytes += Records[i].Bytes;
+				ValidLength++;
+			}
+			else
+			{
+				Rejected++;
+			}
+		}
+		Validate.Count += ValidLength;
+		Validate.Seconds += WallClock() - Start;
+
+		// add the valid records to the database
+		Start = WallClock();
+		unsigned long Added = BulkEnter(Batch, ValidLength);
+		for (unsigned long i = 0; i < Added; i++)
+		{
+			Insert.Bytes += BatchBytes[i];
+		}
+		Insert.Count += Added;
+		NotAdded += ValidLength - Added;
+		Insert.Seconds += WallClock() - Start;
+	}
+
+	instream.close();
+
+	cout << Insert.Count << " elements imported" << endl;
+	if (TooLong > 0)
+	{
+		cout << TooLong << " records were longer than " << IMPORT_RECORD_MAX - 1 << " characters" << endl;
+	}
+	if (Rejected > 0)
+	{
+		cout << Rejected << " records could not be read or were not valid" << endl;
+	}
+	if (NotAdded > 0)
+	{
+		cout << NotAdded << " elements did not fit in the database" << endl;
+	}
+
+	PipelineStage Stages[] = { Reader.ReadStage, Reader.SplitStage, Parse, Validate, Insert };
+	DisplayPipelineStages(Stages, sizeof(Stages) / sizeof(Stages[0]));
+}
+
+// Write a name as the text of a JSON string, escaping quotes, backslashes and
+// control characters
+// Arguments:
+//   (1) the name
+//   (2) filled with the escaped name
+//   (3) the size of the escaped name
+// Returns: void
+static void EscapeJsonString(const char *Text, char *Escaped, size_t Size)
+{
+	size_t Length = 0;
+
+	// an escaped character takes at most six characters
+	for (; *Text != '\0' && Length + 7 <= Size; Text++)
+	{
+		unsigned char Character = (unsigned char)*Text;
+
+		if (Character == '"' || Character == '\\')
+		{
+			Escaped[Length++] = '\\';
+			Escaped[Length++] = (char)Character;
+		}
+		else if (Character < 0x20)
+		{
+			Length += snprintf(Escaped + Length, Size - Length, "\\u%04x", Character);
+		}
+		else
+		{
+			Escaped[Length++] = (char)Character;
+		}
+	}
+	Escaped[Length] = '\0';
+}
+
+// Write a name as a CSV field. A name containing commas or quotes is quoted,
+// with each quote in it doubled.
+// Arguments:
+//   (1) the name
+//   (2) filled with the field
+//   (3) the size of the field
+// Returns: void
+static void QuoteCsvField(const char *Text, char *Field, size_t Size)
+{
+	size_t Length = 0;
+
+	if (strpbrk(Text, ",\"") == NULL)
+	{
+		snprintf(Field, Size, "%s", Text);
+		return;
+	}
+
+	// a quoted character takes at most two characters, plus the closing quote
+	Field[Length++] = '"';
+	for (; *Text != '\0' && Length + 4 <= Size; Text++)
+	{
+		if (*Text == '"')
+		{
+			Field[Length++] = '"';
+		}
+		Field[Length++] = *Text;
+	}
+	Field[Length++] = '"';
+	Field[Length] = '\0';
+}
+
+// Export the op-amps matching a query as CSV or JSON. The database is searched a
+// batch of positions at a time and each op-amp is written as soon as it is
+// formatted, so the result of the query is never copied.
+// Arguments:
+//   (1) the stream to write to
+//   (2) true for JSON, false for CSV
+//   (3) the number of pins queried, 0 for any
+//   (4) the minimum slew rate queried
+// Returns: void
+void OpAmpDatabase::Export(ostream &outstream, bool Json, unsigned int PinCount, double MinSlewRate)
+{
+	PipelineStage Select = { "Select", "records", 0, 0, 0.0 };
+	PipelineStage Write = { "Write", "records", 0, 0, 0.0 };
+
+	unsigned long Positions[PIPELINE_BATCH];	// positions of the matching op-amps in a batch
+	char Name[OPAMP_NAME_MAX * 6];				// the name of an op-amp, quoted or escaped
+	char Line[IMPORT_RECORD_MAX + sizeof(Name)];	// a formatted op-amp
+	unsigned long Next = 0;						// the next position to be searched
+
+	outstream << (Json ? "[" : "name,pins,slewrate") << endl;
+
+	while (Next < database_length)
+	{
+		// find a batch of matching op-amps
+		double Start = WallClock();
+		unsigned long BatchLength = 0;
+		while (BatchLength < PIPELINE_BATCH && Next < database_length)
+		{
+			if (IsMatch(Next, PinCount, MinSlewRate))
+			{
+				Positions[BatchLength++] = Next;
+			}
+			Next++;
+		}
+		Select.Count += BatchLength;
+		Select.Bytes += BatchLength * sizeof(OpAmps);
+		Select.Seconds += WallClock() - Start;
+
+		// write the batch
+		Start = WallClock();
+		for (unsigned long i = 0; i < BatchLength; i++)
+		{
+			OpAmps &OpAmp = ArrayOfOpAmps[Positions[i]];
+			int Length;
+
+			if (Json)
+			{
+				EscapeJsonString(OpAmp.GetNameOpAmp(), Name, sizeof(Name));
+				Length = snprintf(Line, sizeof(Line), "%s  {\"name\": \"%s\", \"pins\": %d, \"slewrate\": %g}",
+					Write.Count > 0 ? ",\n" : "", Name, OpAmp.GetPinCountOpAmp(), OpAmp.GetSlewRateOpAmp());
+			}
+			else
+			{
+				QuoteCsvField(OpAmp.GetNameOpAmp(), Name, sizeof(Name));
+				Length = snprintf(Line, sizeof(Line), "%s,%d,%g\n",
+					Name, OpAmp.GetPinCountOpAmp(), OpAmp.GetSlewRateOpAmp());
+			}
+			if (Length >= (int)sizeof(Line))
+			{
+				Length = sizeof(Line) - 1;
+			}
+
+			outstream.write(Line, Length);
+			Write.Count++;
+			Write.Bytes += Length;
+		}
+		Write.Seconds += WallClock() - Start;
+	}
+
+	if (Json)
+	{
+		outstream << (Write.Count > 0 ? "\n]" : "]") << endl;
+	}
+
+	// the time to write out what is still buffered is part of the write stage
+	double FlushStart = WallClock();
+	outstream.flush();
+	Write.Seconds += WallClock() - FlushStart;
+
+	PipelineStage Stages[] = { Select, Write };
+	DisplayPipelineStages(Stages, sizeof(Stages) / sizeof(Stages[0]));
+}
+
+// Import op-amps from a file or export the result of a query to a file or to the
+// screen
+// Arguments: None
+// Returns: void
+void OpAmpDatabase::ImportExport()
+{
+	char UserInput;
+	char FileName[256];
+	unsigned int PinCount;
+	double MinSlewRate;
+
+	// show the menu of options
+	cout << endl;
+	cout << "Import and export options" << endl;
+	cout << "-------------------------" << endl;
+	cout << "1. Import from a CSV file" << endl;
+	cout << "2. Import from a JSON file" << endl;
+	cout << "3. Export to a CSV file" << endl;
+	cout << "4. Export to a JSON file" << endl;
+	cout << "5. Export to the screen" << endl;
+	cout << "6. Cancel" << endl << endl;
+
+	// get the user's choice of operation
+	cout << "Enter your option: ";
+	cin >> UserInput;
+	cout << endl;
+
+	if (UserInput < '1' || UserInput > '5')
+	{
+		if (UserInput != '6')
+		{
+			cout << "Invalid entry" << endl << endl;
+		}
+		return;
+	}
+
+	if (UserInput != '5')
+	{
+		cout << "Enter file name: ";
+		cin.width(sizeof(FileName));
+		cin >> FileName;
+	}
+
+	if (UserInput == '1' || UserInput == '2')
+	{
+		Import(FileName, UserInput == '2');
+		return;
+	}
+
+	cout << "Enter number of pins (0 for any): ";
+	cin >> PinCount;
+	cout << "Enter minimum slew rate: ";
+	cin >> MinSlewRate;
+	cout << endl;
+
+	if (UserInput == '5')
+	{
+		Export(cout, false, PinCount, MinSlewRate);
+		return;
+	}
+
+	ofstream outstream;  // file stream for output
+
+	outstream.open(FileName, ios::out);	// open the file
+
+	if (!outstream.good())
+	{
+		cerr << "ERROR: Could not create file " << FileName << endl;
+		return;
+	}
+
+	Export(outstream, UserInput == '4', PinCount, MinSlewRate);
+	outstream.close();
+}
+
+// Check whether a name contains a text, ignoring case
+// Arguments:
+//   (1) the name
+//   (2) the text
+// Returns: true if the name contains the text
+static bool ContainsText(const char *Name, const char *Text)
+{
+	size_t NameLength = strlen(Name);
+	size_t TextLength = strlen(Text);
+
+	for (size_t i = 0; i + TextLength <= NameLength; i++)
+	{
+		size_t j = 0;
+		while (j < TextLength && toupper((unsigned char)Name[i + j]) == toupper((unsigned char)Text[j]))
+		{
+			j++;
+		}
+		if (j == TextLength)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// Find the number of edits (characters inserted, removed or changed) needed to
+// turn a name into a text, ignoring case
+// Arguments:
+//   (1) the name
+//   (2) the text, shorter than SEARCH_TEXT_MAX
+// Returns: the number of edits
+static unsigned long EditDistance(const char *Name, const char *Text)
+{
+	unsigned long Previous[SEARCH_TEXT_MAX + 1];	// edits for the name so far
+	unsigned long Current[SEARCH_TEXT_MAX + 1];		// edits with one more character of the name
+	size_t TextLength = strlen(Text);
+
+	for (size_t j = 0; j <= TextLength; j++)
+	{
+		Previous[j] = j;
+	}
+
+	for (size_t i = 0; Name[i] != '\0'; i++)
+	{
+		Current[0] = i + 1;
+		for (size_t j = 1; j <= TextLength; j++)
+		{
+			unsigned long Change = Previous[j - 1] +
+				(toupper((unsigned char)Name[i]) != toupper((unsigned char)Text[j - 1]) ? 1 : 0);
+			Current[j] = min(Change, min(Previous[j], Current[j - 1]) + 1);
+		}
+		copy(Current, Current + TextLength + 1, Previous);
+	}
+
+	return Previous[TextLength];
+}
+
+// Find the op-amps whose name contains a text, or whose name is within a number
+// of edits of a text. The name index narrows down the names to be checked.
+// Arguments:
+//   (1) true to find similar names, false to find names containing the text
+// Returns: void
+void OpAmpDatabase::SearchName(bool Similar)
+{
+	char Text[SEARCH_TEXT_MAX];
+	unsigned long MaxEdits = 0;
+
+	cout << "Enter name: ";
+	cin.width(SEARCH_TEXT_MAX);
+	cin >> Text;
+	if (Similar)
+	{
+		cout << "Enter number of characters which may differ: ";
+		cin >> MaxEdits;
+	}
+	cout << endl;
+
+	unsigned long Candidates[DATABASE_MAX];	// positions of the names to be checked
+	unsigned long CandidateCount = Names.Search(Text, MaxEdits, Candidates);
+	unsigned long ResultCount = 0;
+
+	for (unsigned long i = 0; i < CandidateCount; i++)
+	{
+		const char *Name = ArrayOfOpAmps[Candidates[i]].GetNameOpAmp();
+
+		if (Similar ? EditDistance(Name, Text) <= MaxEdits : ContainsText(Name, Text))
+		{
+			ArrayOfOpAmps[Candidates[i]].DisplayOpAmpValues();
+			ResultCount++;
 		}
 	}
+
+	if (ResultCount == 0)
+	{
+		cout << "No matching elements in the database" << endl;
+	}
 }
\ No newline at end of file